@@ -0,0 +1,96 @@
+#include "simple_vector.h"
+#include "eytzinger_index.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace std;
+
+// Сравнивает поиск в EytzingerIndex со std::lower_bound по отсортированному SimpleVector.
+// Размеры растут от нескольких килобайт (L1) до 2^max_log_size ключей.
+// Использование: eytzinger_benchmark [max_log_size] [query_count]
+
+namespace {
+
+    template<typename Function>
+    double MeasureNsPerQuery(size_t query_count, Function function) {
+        const auto start = chrono::steady_clock::now();
+        function();
+        const auto finish = chrono::steady_clock::now();
+        return chrono::duration<double, nano>(finish - start).count() / static_cast<double>(query_count);
+    }
+
+    void RunBenchmark(size_t size, size_t query_count, mt19937 &generator) {
+        SimpleVector<uint32_t> sorted(size);
+        uniform_int_distribution<uint32_t> distribution;
+        for (auto &key: sorted) {
+            key = distribution(generator);
+        }
+        sort(sorted.begin(), sorted.end());
+
+        SimpleVector<uint32_t> queries(query_count);
+        for (auto &query: queries) {
+            query = distribution(generator);
+        }
+
+        const EytzingerIndex<uint32_t> index(sorted);
+
+        size_t checksum_lower_bound = 0;
+        const double lower_bound_ns = MeasureNsPerQuery(query_count, [&] {
+            for (const uint32_t query: queries) {
+                checksum_lower_bound += lower_bound(sorted.begin(), sorted.end(), query) - sorted.begin();
+            }
+        });
+
+        size_t checksum_index = 0;
+        const double index_ns = MeasureNsPerQuery(query_count, [&] {
+            for (const uint32_t query: queries) {
+                checksum_index += index.LowerBound(query);
+            }
+        });
+
+        // Буфер ответов выделен заранее: замер не включает выделение памяти
+        SimpleVector<size_t> positions(Reserve(query_count));
+        size_t checksum_batch = 0;
+        const double batch_ns = MeasureNsPerQuery(query_count, [&] {
+            index.LowerBoundBatch(queries, positions);
+            for (const size_t position: positions) {
+                checksum_batch += position;
+            }
+        });
+
+        if (checksum_lower_bound != checksum_index || checksum_lower_bound != checksum_batch) {
+            cerr << "Checksum mismatch for size "s << size << endl;
+            exit(1);
+        }
+
+        cout << setw(12) << size
+             << setw(12) << size * sizeof(uint32_t) / 1024
+             << setw(16) << fixed << setprecision(1) << lower_bound_ns
+             << setw(16) << index_ns
+             << setw(16) << batch_ns << endl;
+    }
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const size_t max_log_size = argc > 1 ? stoul(argv[1]) : 26;
+    const size_t query_count = argc > 2 ? stoul(argv[2]) : 1000000;
+
+    mt19937 generator(42);
+    cout << setw(12) << "keys"s
+         << setw(12) << "KiB"s
+         << setw(16) << "lower_bound ns"s
+         << setw(16) << "index ns"s
+         << setw(16) << "batch ns"s << endl;
+    for (size_t log_size = 10; log_size <= max_log_size; log_size += 2) {
+        RunBenchmark(size_t{1} << log_size, query_count, generator);
+    }
+    return 0;
+}
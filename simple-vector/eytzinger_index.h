@@ -0,0 +1,159 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+// Индекс только для чтения, построенный по отсортированному SimpleVector.
+// Ключи хранятся в порядке Эйтцингера (как в двоичной куче): потомки узла k лежат
+// в позициях 2k и 2k + 1. Первые уровни дерева оказываются рядом в памяти и остаются в кэше,
+// а потомков на несколько уровней вперёд можно запросить заранее одной предвыборкой.
+// Для каждого узла хранится ещё и его позиция в исходном векторе. Позиции лежат отдельным массивом
+// типа Rank, чтобы в кэш-линию помещалось больше ключей; по умолчанию это uint32_t,
+// что ограничивает размер индекса 2^32 - 1 ключами (ranks_[0] хранит сам размер), но добавляет к ключам всего 4 байта на узел
+template<typename Key, typename Rank = uint32_t>
+class EytzingerIndex {
+public:
+    EytzingerIndex() : EytzingerIndex(SimpleVector<Key>()) {}
+
+    // sorted должен быть отсортирован по возрастанию.
+    // Выбрасывает исключение std::length_error, если позиции ключей не помещаются в Rank
+    explicit EytzingerIndex(const SimpleVector<Key> &sorted) : size_(sorted.GetSize()) {
+        assert(std::is_sorted(sorted.begin(), sorted.end()));
+        if (size_ > std::numeric_limits<Rank>::max()) {
+            throw std::length_error("Too many keys for the rank type");
+        }
+        AllocateKeys();
+        ranks_ = ArrayPtr<Rank>(size_ + 1);
+        size_t next_rank = 0;
+        Build(sorted, next_rank, 1);
+        ranks_[0] = static_cast<Rank>(size_);
+        while ((size_t{1} << height_) <= size_) {
+            ++height_;
+        }
+    }
+
+    // Возвращает количество ключей в индексе
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает позицию в исходном векторе первого ключа, не меньшего key,
+    // или GetSize(), если такого ключа нет
+    [[nodiscard]] size_t LowerBound(const Key &key) const {
+        return ranks_[Search(key)];
+    }
+
+    // Сообщает, есть ли key в индексе
+    [[nodiscard]] bool Contains(const Key &key) const {
+        const size_t node = Search(key);
+        return node != 0 && !(key < keys_[node]);
+    }
+
+    // Выполняет LowerBound для каждого запроса.
+    // Запросы обрабатываются группами: на каждом уровне дерева все запросы группы делают по шагу,
+    // поэтому промахи кэша разных запросов перекрываются, а не ждут друг друга
+    [[nodiscard]] SimpleVector<size_t> LowerBoundBatch(const SimpleVector<Key> &queries) const {
+        SimpleVector<size_t> result(Reserve(queries.GetSize()));
+        LowerBoundBatch(queries, result);
+        return result;
+    }
+
+    // То же, но записывает ответы в result, заменяя его содержимое.
+    // Если вместимости result хватает, память не выделяется, поэтому один вектор
+    // можно переиспользовать для многих пачек запросов
+    void LowerBoundBatch(const SimpleVector<Key> &queries, SimpleVector<size_t> &result) const {
+        result.Clear();
+        result.Reserve(queries.GetSize());
+        size_t nodes[kBatchSize];
+        for (size_t first = 0; first < queries.GetSize(); first += kBatchSize) {
+            const size_t count = std::min(kBatchSize, queries.GetSize() - first);
+            std::fill(nodes, nodes + count, 1);
+            for (size_t level = 0; level < height_; ++level) {
+                for (size_t i = 0; i < count; ++i) {
+                    const size_t node = nodes[i];
+                    if (node <= size_) {
+                        Prefetch(node);
+                        nodes[i] = 2 * node + (keys_[node] < queries[first + i]);
+                    }
+                }
+            }
+            for (size_t i = 0; i < count; ++i) {
+                result.PushBack(ranks_[RestoreNode(nodes[i])]);
+            }
+        }
+    }
+
+private:
+    // Столько ключей помещается в кэш-линию: потомки узла k через log2(kBlockSize) уровней
+    // лежат подряд начиная с позиции k * kBlockSize
+    static constexpr size_t kBlockSize = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+    static constexpr size_t kBatchSize = 16;
+    static constexpr size_t kCacheLineSize = 64;
+
+    // Выделяет память под узлы так, чтобы нулевой узел, а значит, и каждый блок потомков
+    // k * kBlockSize, начинался с границы кэш-линии. Иначе блок делится между двумя линиями
+    // и предвыборка загружает только половину нужных узлов
+    void AllocateKeys() {
+        storage_ = ArrayPtr<Key>(size_ + 1 + kBlockSize);
+        size_t offset = 0;
+        while (offset < kBlockSize
+               && reinterpret_cast<std::uintptr_t>(storage_.Get() + offset) % kCacheLineSize != 0) {
+            ++offset;
+        }
+        keys_ = storage_.Get() + (offset < kBlockSize ? offset : 0);
+    }
+
+    // Раскладывает sorted по узлам обходом дерева в симметричном порядке
+    void Build(const SimpleVector<Key> &sorted, size_t &next_rank, size_t node) {
+        if (node > size_) {
+            return;
+        }
+        Build(sorted, next_rank, 2 * node);
+        keys_[node] = sorted[next_rank];
+        ranks_[node] = static_cast<Rank>(next_rank++);
+        Build(sorted, next_rank, 2 * node + 1);
+    }
+
+    // Возвращает узел с первым ключом, не меньшим key, или 0, если такого ключа нет
+    size_t Search(const Key &key) const {
+        size_t node = 1;
+        while (node <= size_) {
+            Prefetch(node);
+            node = 2 * node + (keys_[node] < key);
+        }
+        return RestoreNode(node);
+    }
+
+    void Prefetch([[maybe_unused]] size_t node) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        // Адрес может выйти за пределы массива: предвыборка не обращается к памяти и не падает
+        __builtin_prefetch(reinterpret_cast<const void *>(
+                reinterpret_cast<std::uintptr_t>(keys_) + node * kBlockSize * sizeof(Key)));
+#endif
+    }
+
+    // Спуск заканчивается за листом. Последний поворот налево указывает на ответ:
+    // отбрасываем все повороты направо после него и сам этот поворот
+    static size_t RestoreNode(size_t node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return node >> __builtin_ffsll(static_cast<long long>(~node));
+#else
+        while (node & 1) {
+            node >>= 1;
+        }
+        return node >> 1;
+#endif
+    }
+
+    ArrayPtr<Key> storage_;
+    Key *keys_ = nullptr;
+    ArrayPtr<Rank> ranks_;
+    size_t size_ = 0;
+    size_t height_ = 0;
+};
@@ -1,8 +1,12 @@
 #include "simple_vector.h"
+#include "eytzinger_index.h"
+#include "radix_sort.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <numeric>
+#include <random>
 #include <string>
 
 using namespace std;
@@ -187,6 +191,308 @@ void TestReserveMethod() {
     cout << "Done!"s << endl;
 }
 
+void TestVectorExpressions() {
+    cout << "TestVectorExpressions"s << endl;
+    const SimpleVector<double> a{1.0, 2.0, 3.0, 4.0};
+    const SimpleVector<double> b{10.0, 20.0, 30.0, 40.0};
+    const SimpleVector<double> c{0.5, 0.5, 0.5, 0.5};
+
+    // построение вектора из выражения
+    SimpleVector<double> result = a * 2 + b - c;
+    assert(result.GetSize() == 4);
+    for (size_t i = 0; i < result.GetSize(); ++i) {
+        assert(result[i] == a[i] * 2 + b[i] - c[i]);
+    }
+
+    // присваивание выражения с изменением размера
+    SimpleVector<double> v;
+    v = -a / 2.0 + 1;
+    assert(v.GetSize() == 4);
+    assert(v[3] == -1.0);
+
+    // вектор как операнд собственного выражения
+    v = v * v;
+    assert(v[3] == 1.0);
+    assert(v[0] == 0.25);
+
+    // присваивание в зарезервированный вектор не выделяет память
+    {
+        SimpleVector<double> reserved(Reserve(10));
+        const double *data = reserved.begin();
+        reserved = a * 2;
+        assert(reserved.GetSize() == 4 && reserved.GetCapacity() == 10);
+        assert(reserved.begin() == data && reserved[3] == 8.0);
+        reserved.Clear();
+        reserved = b + c;
+        assert(reserved.begin() == data && reserved[0] == 10.5);
+        reserved.AssignParallel(a - a, 2);
+        assert(reserved.begin() == data && reserved[1] == 0.0);
+    }
+
+    // поэлементное сравнение со скаляром и с выражением
+    SimpleVector<bool> mask = a > 2.0;
+    assert(!mask[0] && !mask[1] && mask[2] && mask[3]);
+    mask = AsExpression(a) == b / 10;
+    assert(mask[0] && mask[1] && mask[2] && mask[3]);
+
+    // сравнение двух векторов остаётся лексикографическим
+    assert(a < b);
+    assert(a != b);
+    cout << "Done!"s << endl;
+}
+
+void TestVectorExpressionParallel() {
+    cout << "TestVectorExpressionParallel"s << endl;
+    const size_t size = 1000000;
+    SimpleVector<int> a = GenerateVector(size);
+    SimpleVector<int> b = GenerateVector(size);
+    SimpleVector<int> result;
+    result.AssignParallel(a * 3 - b, 4);
+    assert(result.GetSize() == size);
+    for (size_t i = 0; i < size; ++i) {
+        assert(result[i] == 2 * static_cast<int>(i + 1));
+    }
+    result.AssignParallel(result + a);
+    assert(result[size - 1] == 3 * static_cast<int>(size));
+    result.AssignParallel(result - a, 1000000);
+    assert(result[size - 1] == 2 * static_cast<int>(size));
+    result.AssignParallel(result + a);
+    assert(result[size - 1] == 3 * static_cast<int>(size));
+    cout << "Done!"s << endl;
+}
+
+void TestEytzingerIndex() {
+    cout << "TestEytzingerIndex"s << endl;
+    // один буфер ответов на все пачки запросов
+    SimpleVector<size_t> reused(Reserve(100));
+    const size_t *reused_data = reused.begin();
+    for (size_t size = 0; size < 70; ++size) {
+        SimpleVector<int> sorted(size);
+        for (size_t i = 0; i < size; ++i) {
+            sorted[i] = static_cast<int>(i / 2 * 2);
+        }
+        const EytzingerIndex<int> index(sorted);
+        assert(index.GetSize() == size);
+
+        SimpleVector<int> queries;
+        for (int key = -1; key <= static_cast<int>(size) + 1; ++key) {
+            queries.PushBack(key);
+        }
+        const SimpleVector<size_t> batch = index.LowerBoundBatch(queries);
+        assert(batch.GetSize() == queries.GetSize());
+        index.LowerBoundBatch(queries, reused);
+        assert(reused.GetSize() == queries.GetSize());
+        for (size_t i = 0; i < queries.GetSize(); ++i) {
+            const int key = queries[i];
+            const size_t expected = lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+            assert(index.LowerBound(key) == expected);
+            assert(batch[i] == expected);
+            assert(reused[i] == expected);
+            assert(index.Contains(key) == binary_search(sorted.begin(), sorted.end(), key));
+        }
+    }
+
+    assert(reused.begin() == reused_data);
+
+    const EytzingerIndex<int> empty;
+    assert(empty.LowerBound(42) == 0);
+    assert(!empty.Contains(42));
+
+    // позиции не помещаются в тип Rank
+    try {
+        const EytzingerIndex<int, uint8_t> index(GenerateVector(256));
+        assert(false);  // Ожидается выбрасывание исключения
+    } catch (const std::length_error&) {
+    } catch (...) {
+        assert(false);  // Не ожидается исключение, отличное от length_error
+    }
+    // позиции и размер ровно помещаются в тип Rank
+    const EytzingerIndex<int, uint8_t> small_index(GenerateVector(255));
+    assert(small_index.LowerBound(255) == 254);
+    assert(small_index.LowerBound(256) == 255);
+    assert(small_index.Contains(1) && !small_index.Contains(256));
+    cout << "Done!"s << endl;
+}
+
+template<typename Type, typename Generate>
+SimpleVector<Type> GenerateRandomVector(size_t size, Generate generate) {
+    SimpleVector<Type> v(size);
+    for (auto &item: v) {
+        item = generate();
+    }
+    return v;
+}
+
+void TestRadixSort() {
+    cout << "TestRadixSort"s << endl;
+    mt19937_64 generator(42);
+    SortBuffer<int64_t> buffer(Reserve(1000));
+    assert(buffer.GetCapacity() == 1000);
+
+    for (const size_t size: {0, 1, 100, 1000, 100000}) {
+        {
+            auto v = GenerateRandomVector<int64_t>(size, [&] {
+                return static_cast<int64_t>(generator());
+            });
+            SimpleVector<int64_t> expected = v;
+            sort(expected.begin(), expected.end());
+            Sort(v, buffer);
+            assert(v == expected);
+        }
+        {
+            auto v = GenerateRandomVector<uint64_t>(size, [&] {
+                return generator() % 1000;
+            });
+            SimpleVector<uint64_t> expected = v;
+            sort(expected.begin(), expected.end());
+            StableSort(v);
+            assert(v == expected);
+        }
+        {
+            uniform_real_distribution<double> distribution(-1e6, 1e6);
+            auto v = GenerateRandomVector<double>(size, [&] {
+                return distribution(generator);
+            });
+            SimpleVector<double> expected = v;
+            sort(expected.begin(), expected.end());
+            Sort(v);
+            assert(v == expected);
+        }
+        {
+            auto v = GenerateRandomVector<pair<uint32_t, uint32_t>>(size, [&] {
+                return pair<uint32_t, uint32_t>(generator() % 100, static_cast<uint32_t>(generator()));
+            });
+            SimpleVector<pair<uint32_t, uint32_t>> expected = v;
+            sort(expected.begin(), expected.end());
+            Sort(v);
+            assert(v == expected);
+        }
+    }
+    assert(buffer.GetCapacity() == 100000);
+
+    // -0.0 и +0.0 равны: устойчивая сортировка не должна менять их порядок
+    {
+        SimpleVector<double> v(300, 1.0);
+        v[0] = 0.0;
+        v[1] = -0.0;
+        StableSort(v);
+        assert(v[0] == 0.0 && !signbit(v[0]));
+        assert(v[1] == 0.0 && signbit(v[1]));
+    }
+    {
+        SimpleVector<pair<float, uint32_t>> v(300, {1.0f, 0});
+        v[0] = {0.0f, 0};
+        v[1] = {-0.0f, 1};
+        Sort(v);
+        assert(is_sorted(v.begin(), v.end()));
+        assert(v[0].second == 0 && v[1].second == 1);
+    }
+
+    // типы без поразрядной сортировки
+#ifdef __SIZEOF_INT128__
+    {
+        auto v = GenerateRandomVector<__int128>(1000, [&] {
+            return static_cast<__int128>(generator()) << 64 | generator();
+        });
+        StableSort(v);
+        assert(is_sorted(v.begin(), v.end()));
+        ParallelSort(v, 4);
+        assert(is_sorted(v.begin(), v.end()));
+    }
+#endif
+    SimpleVector<string> words{"delta"s, "alpha"s, "charlie"s, "bravo"s};
+    Sort(words);
+    assert((words == SimpleVector<string>{"alpha"s, "bravo"s, "charlie"s, "delta"s}));
+    cout << "Done!"s << endl;
+}
+
+void TestSortByKey() {
+    cout << "TestSortByKey"s << endl;
+    struct Record {
+        int32_t key = 0;
+        size_t position = 0;
+    };
+    mt19937 generator(42);
+    const size_t size = 10000;
+    SimpleVector<Record> records(size);
+    for (size_t i = 0; i < size; ++i) {
+        records[i] = {static_cast<int32_t>(generator() % 200) - 100, i};
+    }
+    SortByKey(records, [](const Record &record) {
+        return record.key;
+    });
+    for (size_t i = 1; i < size; ++i) {
+        assert(records[i - 1].key <= records[i].key);
+        if (records[i - 1].key == records[i].key) {
+            assert(records[i - 1].position < records[i].position);
+        }
+    }
+    cout << "Done!"s << endl;
+}
+
+void TestParallelSort() {
+    cout << "TestParallelSort"s << endl;
+    mt19937_64 generator(42);
+    const size_t size = 1000000;
+    {
+        auto v = GenerateRandomVector<uint64_t>(size, [&] {
+            return generator();
+        });
+        SimpleVector<uint64_t> expected = v;
+        sort(expected.begin(), expected.end());
+        ParallelSort(v, 4);
+        assert(v == expected);
+    }
+    {
+        // ключи занимают только три младших байта, корзины делят их диапазон
+        auto v = GenerateRandomVector<int32_t>(size, [&] {
+            return static_cast<int32_t>(generator() % 100000);
+        });
+        SimpleVector<int32_t> expected = v;
+        sort(expected.begin(), expected.end());
+        SortBuffer<int32_t> buffer;
+        ParallelSort(v, buffer, 3);
+        assert(v == expected);
+        assert(buffer.GetCapacity() == size);
+    }
+    {
+        // отрицательные и положительные ключи в узком диапазоне
+        auto v = GenerateRandomVector<int64_t>(size, [&] {
+            return static_cast<int64_t>(generator() % 100000) - 50000;
+        });
+        SimpleVector<int64_t> expected = v;
+        sort(expected.begin(), expected.end());
+        ParallelSort(v, 4);
+        assert(v == expected);
+    }
+    {
+        // почти все ключи попадают в одну корзину из-за редких больших значений
+        auto v = GenerateRandomVector<uint64_t>(size, [&] {
+            return generator() % 1000 == 0 ? generator() : generator() % 1000000;
+        });
+        SimpleVector<uint64_t> expected = v;
+        sort(expected.begin(), expected.end());
+        ParallelSort(v, 4);
+        assert(v == expected);
+    }
+    {
+        // число потоков ограничивается размером вектора
+        auto v = GenerateRandomVector<uint32_t>(1 << 17, [&] {
+            return static_cast<uint32_t>(generator());
+        });
+        SimpleVector<uint32_t> expected = v;
+        sort(expected.begin(), expected.end());
+        ParallelSort(v, 1000000);
+        assert(v == expected);
+    }
+    {
+        SimpleVector<float> v(size, 1.5f);
+        ParallelSort(v, 4);
+        assert(v == SimpleVector<float>(size, 1.5f));
+    }
+    cout << "Done!"s << endl;
+}
+
 inline void Test1() {
     // Инициализация конструктором по умолчанию
     {
@@ -310,5 +616,11 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestVectorExpressions();
+    TestVectorExpressionParallel();
+    TestEytzingerIndex();
+    TestRadixSort();
+    TestSortByKey();
+    TestParallelSort();
     return 0;
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace parallel_detail {
+
+    // Возвращает, сколько потоков стоит запустить для обработки size элементов.
+    // При thread_count == 0 берётся std::thread::hardware_concurrency().
+    // На каждый поток приходится не меньше min_chunk_size элементов: запуск потока дороже их обработки
+    inline size_t GetThreadCount(size_t thread_count, size_t size, size_t min_chunk_size) {
+        if (thread_count == 0) {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        return std::max<size_t>(1, std::min(thread_count, size / min_chunk_size));
+    }
+
+    // Вызывает function(t) для каждого t из [0, thread_count), нулевую часть — в текущем потоке.
+    // Если очередной поток не запустился или function выбросила исключение в текущем потоке,
+    // сначала дожидается уже запущенных потоков и только потом пробрасывает исключение
+    template<typename Function>
+    void RunInThreads(size_t thread_count, Function function) {
+        std::vector<std::thread> workers;
+        const auto join_all = [&workers] {
+            for (auto &worker: workers) {
+                worker.join();
+            }
+        };
+        try {
+            workers.reserve(thread_count - 1);
+            for (size_t t = 1; t < thread_count; ++t) {
+                workers.emplace_back(function, t);
+            }
+            function(0);
+        } catch (...) {
+            join_all();
+            throw;
+        }
+        join_all();
+    }
+
+} // namespace parallel_detail
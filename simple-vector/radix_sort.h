@@ -0,0 +1,374 @@
+#pragma once
+
+#include "parallel.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Вспомогательный буфер для сортировок SimpleVector.
+// Поразрядной сортировке нужен буфер размером с сортируемый вектор. Если сортировать
+// много векторов подряд, буфер можно создать один раз и передавать в каждый вызов
+template<typename Type>
+class SortBuffer {
+public:
+    SortBuffer() noexcept = default;
+
+    explicit SortBuffer(ReserveProxyObj new_capacity) : items_(new_capacity.capacity),
+                                                        capacity_(new_capacity.capacity) {}
+
+    // Увеличивает вместимость буфера. Содержимое буфера при этом не сохраняется
+    void Reserve(size_t new_capacity) {
+        if (capacity_ < new_capacity) {
+            ArrayPtr<Type> new_items(new_capacity);
+            items_.swap(new_items);
+            capacity_ = new_capacity;
+        }
+    }
+
+    // Возвращает вместимость буфера
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    Type *Get() noexcept {
+        return items_.Get();
+    }
+
+private:
+    ArrayPtr<Type> items_;
+    size_t capacity_ = 0;
+};
+
+namespace radix_sort_detail {
+
+    // Отображает ключ в беззнаковое целое так, что порядок целых совпадает с порядком ключей.
+    // Для типов без такого отображения kEnabled == false, и они сортируются сравнениями
+    template<typename Key, typename = void>
+    struct RadixKey {
+        static constexpr bool kEnabled = false;
+    };
+
+    // Целые шире 64 бит (например, __int128) в ключ не помещаются и сортируются сравнениями
+    template<typename Key>
+    struct RadixKey<Key, std::enable_if_t<std::is_integral_v<Key> && !std::is_same_v<Key, bool>
+                                          && sizeof(Key) <= sizeof(uint64_t)>> {
+        static constexpr bool kEnabled = true;
+        using Bits = std::make_unsigned_t<Key>;
+
+        static Bits Get(Key key) noexcept {
+            auto bits = static_cast<Bits>(key);
+            if constexpr (std::is_signed_v<Key>) {
+                bits ^= Bits{1} << (std::numeric_limits<Bits>::digits - 1);
+            }
+            return bits;
+        }
+    };
+
+    // У отрицательных чисел инвертируются все биты, у неотрицательных — только знаковый.
+    // -0.0 и +0.0 равны при сравнении, поэтому должны получить одинаковый ключ
+    template<typename Key>
+    struct RadixKey<Key, std::enable_if_t<std::is_floating_point_v<Key>
+                                          && std::numeric_limits<Key>::is_iec559
+                                          && (sizeof(Key) == 4 || sizeof(Key) == 8)>> {
+        static constexpr bool kEnabled = true;
+        using Bits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+
+        static Bits Get(Key key) noexcept {
+            if (key == Key{0}) {
+                key = Key{0};
+            }
+            Bits bits;
+            std::memcpy(&bits, &key, sizeof(Key));
+            const Bits sign = Bits{1} << (std::numeric_limits<Bits>::digits - 1);
+            return (bits & sign) ? ~bits : (bits | sign);
+        }
+    };
+
+    // Пара сравнивается лексикографически, поэтому её ключ — склеенные ключи first и second
+    template<typename First, typename Second>
+    struct RadixKey<std::pair<First, Second>,
+            std::enable_if_t<RadixKey<First>::kEnabled && RadixKey<Second>::kEnabled
+                             && sizeof(typename RadixKey<First>::Bits)
+                                + sizeof(typename RadixKey<Second>::Bits) <= sizeof(uint64_t)>> {
+        static constexpr bool kEnabled = true;
+        using Bits = std::conditional_t<sizeof(typename RadixKey<First>::Bits)
+                                        + sizeof(typename RadixKey<Second>::Bits) <= sizeof(uint32_t),
+                uint32_t, uint64_t>;
+
+        static Bits Get(const std::pair<First, Second> &key) noexcept {
+            const Bits first = RadixKey<First>::Get(key.first);
+            const Bits second = RadixKey<Second>::Get(key.second);
+            return (first << (8 * sizeof(typename RadixKey<Second>::Bits))) | second;
+        }
+    };
+
+    constexpr size_t kRadix = 256;
+    // На коротких массивах подсчёт гистограмм дороже сортировки сравнениями
+    constexpr size_t kMinRadixSortSize = 256;
+    constexpr size_t kMinParallelSortSize = 1 << 16;
+
+    inline size_t GetByte(uint64_t bits, size_t byte) noexcept {
+        return static_cast<size_t>((bits >> (8 * byte)) & (kRadix - 1));
+    }
+
+    // Устойчиво сортирует [data, data + size) по младшим bytes байтам ключа,
+    // начиная с младшего. scratch должен вмещать size элементов.
+    // Проходы, в которых у всех элементов одинаковый байт, пропускаются
+    template<typename Type, typename KeyBits>
+    void LsdRadixSort(Type *data, Type *scratch, size_t size, KeyBits key_bits, size_t bytes) {
+        assert(bytes <= sizeof(uint64_t));
+        if (size == 0) {
+            return;
+        }
+        size_t counts[sizeof(uint64_t)][kRadix] = {};
+        for (size_t i = 0; i < size; ++i) {
+            const uint64_t bits = key_bits(data[i]);
+            for (size_t byte = 0; byte < bytes; ++byte) {
+                ++counts[byte][GetByte(bits, byte)];
+            }
+        }
+
+        Type *source = data;
+        Type *destination = scratch;
+        for (size_t byte = 0; byte < bytes; ++byte) {
+            size_t *count = counts[byte];
+            if (count[GetByte(key_bits(source[0]), byte)] == size) {
+                continue;
+            }
+            size_t offset = 0;
+            for (size_t digit = 0; digit < kRadix; ++digit) {
+                offset += std::exchange(count[digit], offset);
+            }
+            for (size_t i = 0; i < size; ++i) {
+                destination[count[GetByte(key_bits(source[i]), byte)]++] = std::move(source[i]);
+            }
+            std::swap(source, destination);
+        }
+        if (source != data) {
+            std::move(source, source + size, data);
+        }
+    }
+
+    template<typename Type, typename Key, typename KeyExtractor>
+    void SortByKeyImpl(SimpleVector<Type> &vector, SortBuffer<Type> &buffer, KeyExtractor key) {
+        using Traits = RadixKey<Key>;
+        if constexpr (Traits::kEnabled) {
+            if (vector.GetSize() >= kMinRadixSortSize) {
+                buffer.Reserve(vector.GetSize());
+                LsdRadixSort(vector.begin(), buffer.Get(), vector.GetSize(), [&key](const Type &item) {
+                    return static_cast<uint64_t>(Traits::Get(key(item)));
+                }, sizeof(typename Traits::Bits));
+                return;
+            }
+        }
+        std::stable_sort(vector.begin(), vector.end(), [&key](const Type &lhs, const Type &rhs) {
+            return key(lhs) < key(rhs);
+        });
+    }
+
+    // Первый проход MSD делается всеми потоками: каждый поток считает гистограмму своей части
+    // и раскладывает её по корзинам в буфер. Корзины делят отрезок [min, max] ключей на равные
+    // части, поэтому их много даже тогда, когда ключи занимают лишь малую часть разрядной сетки.
+    // Обычные корзины потоки досортировывают LSD по младшим битам независимо друг от друга.
+    // Корзины, в которые попала большая доля элементов, сортируются рекурсивно всеми потоками:
+    // их отрезок ключей в сотни раз уже исходного
+    template<typename Type>
+    void ParallelMsdRadixSort(Type *data, Type *scratch, size_t size, size_t thread_count) {
+        using Traits = RadixKey<Type>;
+        const auto key_bits = [](const Type &item) {
+            return static_cast<uint64_t>(Traits::Get(item));
+        };
+
+        thread_count = parallel_detail::GetThreadCount(thread_count, size, kMinRadixSortSize);
+        const size_t chunk_size = (size + thread_count - 1) / thread_count;
+        const auto run_threads = [thread_count](auto function) {
+            parallel_detail::RunInThreads(thread_count, function);
+        };
+
+        std::vector<std::pair<uint64_t, uint64_t>> ranges(thread_count, {std::numeric_limits<uint64_t>::max(), 0});
+        run_threads([&](size_t t) {
+            auto [min_bits, max_bits] = ranges[t];
+            const size_t last = std::min(size, (t + 1) * chunk_size);
+            for (size_t i = std::min(size, t * chunk_size); i < last; ++i) {
+                const uint64_t bits = key_bits(data[i]);
+                min_bits = std::min(min_bits, bits);
+                max_bits = std::max(max_bits, bits);
+            }
+            ranges[t] = {min_bits, max_bits};
+        });
+        uint64_t min_bits = std::numeric_limits<uint64_t>::max();
+        uint64_t max_bits = 0;
+        for (const auto &[part_min, part_max]: ranges) {
+            min_bits = std::min(min_bits, part_min);
+            max_bits = std::max(max_bits, part_max);
+        }
+        if (min_bits == max_bits) {
+            return;
+        }
+
+        // Номер корзины — старшие 8 значащих битов разности ключа и минимального ключа,
+        // внутри корзины остаётся отсортировать по младшим shift битам
+        size_t shift = 0;
+        while (((max_bits - min_bits) >> shift) >= kRadix) {
+            ++shift;
+        }
+        const auto get_digit = [&key_bits, min_bits, shift](const Type &item) {
+            return static_cast<size_t>((key_bits(item) - min_bits) >> shift);
+        };
+        const auto low_bits = [&key_bits, min_bits](const Type &item) {
+            return key_bits(item) - min_bits;
+        };
+        const size_t low_bytes = (shift + 7) / 8;
+
+        std::vector<std::array<size_t, kRadix>> counts(thread_count);
+        run_threads([&](size_t t) {
+            counts[t].fill(0);
+            const size_t last = std::min(size, (t + 1) * chunk_size);
+            for (size_t i = std::min(size, t * chunk_size); i < last; ++i) {
+                ++counts[t][get_digit(data[i])];
+            }
+        });
+
+        // Части раскладываются в порядке номеров потоков, поэтому сортировка остаётся устойчивой
+        size_t bucket_begin[kRadix + 1];
+        size_t offset = 0;
+        for (size_t digit = 0; digit < kRadix; ++digit) {
+            bucket_begin[digit] = offset;
+            for (size_t t = 0; t < thread_count; ++t) {
+                offset += std::exchange(counts[t][digit], offset);
+            }
+        }
+        bucket_begin[kRadix] = size;
+
+        run_threads([&](size_t t) {
+            const size_t last = std::min(size, (t + 1) * chunk_size);
+            for (size_t i = std::min(size, t * chunk_size); i < last; ++i) {
+                scratch[counts[t][get_digit(data[i])]++] = std::move(data[i]);
+            }
+        });
+
+        const auto is_large_bucket = [&](size_t digit) {
+            const size_t bucket_size = bucket_begin[digit + 1] - bucket_begin[digit];
+            return bucket_size >= kMinParallelSortSize && bucket_size > size / thread_count;
+        };
+
+        std::atomic<size_t> next_bucket{0};
+        run_threads([&](size_t) {
+            for (size_t digit = next_bucket++; digit < kRadix; digit = next_bucket++) {
+                if (is_large_bucket(digit)) {
+                    continue;
+                }
+                const size_t first = bucket_begin[digit];
+                const size_t bucket_size = bucket_begin[digit + 1] - first;
+                if (bucket_size < kMinRadixSortSize) {
+                    std::stable_sort(scratch + first, scratch + first + bucket_size,
+                                     [&key_bits](const Type &lhs, const Type &rhs) {
+                                         return key_bits(lhs) < key_bits(rhs);
+                                     });
+                } else {
+                    LsdRadixSort(scratch + first, data + first, bucket_size, low_bits, low_bytes);
+                }
+                std::move(scratch + first, scratch + first + bucket_size, data + first);
+            }
+        });
+
+        for (size_t digit = 0; digit < kRadix; ++digit) {
+            if (!is_large_bucket(digit)) {
+                continue;
+            }
+            const size_t first = bucket_begin[digit];
+            const size_t bucket_size = bucket_begin[digit + 1] - first;
+            ParallelMsdRadixSort(scratch + first, data + first, bucket_size, thread_count);
+            const size_t move_chunk_size = (bucket_size + thread_count - 1) / thread_count;
+            run_threads([&](size_t t) {
+                const size_t move_first = std::min(bucket_size, t * move_chunk_size);
+                const size_t move_last = std::min(bucket_size, move_first + move_chunk_size);
+                std::move(scratch + first + move_first, scratch + first + move_last, data + first + move_first);
+            });
+        }
+    }
+
+} // namespace radix_sort_detail
+
+// Сортирует вектор по возрастанию, используя buffer как рабочую память.
+// Целые и вещественные числа и пары из них сортируются поразрядно (LSD) за O(n),
+// остальные типы — через std::sort
+template<typename Type>
+void Sort(SimpleVector<Type> &vector, SortBuffer<Type> &buffer) {
+    if constexpr (radix_sort_detail::RadixKey<Type>::kEnabled) {
+        radix_sort_detail::SortByKeyImpl<Type, Type>(vector, buffer, [](const Type &item) -> const Type & {
+            return item;
+        });
+    } else {
+        std::sort(vector.begin(), vector.end());
+    }
+}
+
+template<typename Type>
+void Sort(SimpleVector<Type> &vector) {
+    SortBuffer<Type> buffer;
+    Sort(vector, buffer);
+}
+
+// То же, что Sort, но сохраняет порядок равных элементов.
+// Типы без поразрядной сортировки сортируются через std::stable_sort
+template<typename Type>
+void StableSort(SimpleVector<Type> &vector, SortBuffer<Type> &buffer) {
+    if constexpr (radix_sort_detail::RadixKey<Type>::kEnabled) {
+        Sort(vector, buffer);
+    } else {
+        std::stable_sort(vector.begin(), vector.end());
+    }
+}
+
+template<typename Type>
+void StableSort(SimpleVector<Type> &vector) {
+    SortBuffer<Type> buffer;
+    StableSort(vector, buffer);
+}
+
+// Устойчиво сортирует записи по ключу key(item).
+// Если ключ — число или пара чисел, сортировка поразрядная
+template<typename Type, typename KeyExtractor>
+void SortByKey(SimpleVector<Type> &vector, SortBuffer<Type> &buffer, KeyExtractor key) {
+    using Key = std::decay_t<decltype(key(std::declval<const Type &>()))>;
+    radix_sort_detail::SortByKeyImpl<Type, Key>(vector, buffer, key);
+}
+
+template<typename Type, typename KeyExtractor>
+void SortByKey(SimpleVector<Type> &vector, KeyExtractor key) {
+    SortBuffer<Type> buffer;
+    SortByKey(vector, buffer, key);
+}
+
+// Устойчиво сортирует вектор в thread_count потоках.
+// При thread_count == 0 используется std::thread::hardware_concurrency().
+// Типы без поразрядной сортировки и короткие векторы сортируются как в StableSort
+template<typename Type>
+void ParallelSort(SimpleVector<Type> &vector, SortBuffer<Type> &buffer, size_t thread_count = 0) {
+    thread_count = parallel_detail::GetThreadCount(thread_count, vector.GetSize(), radix_sort_detail::kMinRadixSortSize);
+    if constexpr (radix_sort_detail::RadixKey<Type>::kEnabled) {
+        if (thread_count > 1 && vector.GetSize() >= radix_sort_detail::kMinParallelSortSize) {
+            buffer.Reserve(vector.GetSize());
+            radix_sort_detail::ParallelMsdRadixSort(vector.begin(), buffer.Get(), vector.GetSize(), thread_count);
+            return;
+        }
+    }
+    StableSort(vector, buffer);
+}
+
+template<typename Type>
+void ParallelSort(SimpleVector<Type> &vector, size_t thread_count = 0) {
+    SortBuffer<Type> buffer;
+    ParallelSort(vector, buffer, thread_count);
+}
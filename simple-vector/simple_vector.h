@@ -1,6 +1,7 @@
 #pragma once
 
 #include "array_ptr.h"
+#include "vector_expression.h"
 #include <cassert>
 #include <initializer_list>
 #include <algorithm>
@@ -51,6 +52,14 @@ public:
         std::fill(begin(), end(), Type());
     }
 
+    // Вычисляет ленивое выражение поэлементно за один проход
+    template<typename Expression>
+    SimpleVector(const VectorExpression<Expression> &expression) : items_(expression.Self().GetSize()),
+                                                                   size_(expression.Self().GetSize()),
+                                                                   capacity_(size_) {
+        vector_expression_detail::Evaluate(expression.Self(), items_.Get(), 0, size_);
+    }
+
     explicit SimpleVector(ReserveProxyObj new_capacity) : items_(new_capacity.capacity),
                                                           capacity_(new_capacity.capacity) {}
 
@@ -70,6 +79,32 @@ public:
         return *this;
     }
 
+    // Записывает в вектор результат выражения. Память выделяется, только если не хватает вместимости.
+    // Вектор сам может быть операндом выражения: элементы вычисляются независимо друг от друга
+    template<typename Expression>
+    SimpleVector &operator=(const VectorExpression<Expression> &expression) {
+        AssignParallel(expression, 1);
+        return *this;
+    }
+
+    // То же, что присваивание выражения, но вычисление делится между thread_count потоками.
+    // При thread_count == 0 используется std::thread::hardware_concurrency()
+    template<typename Expression>
+    void AssignParallel(const VectorExpression<Expression> &expression, size_t thread_count = 0) {
+        // Если вектор — операнд выражения, его размер совпадает с размером выражения.
+        // Поэтому при любом другом размере старые элементы можно сразу перезаписывать
+        const size_t new_size = expression.Self().GetSize();
+        if (new_size <= capacity_) {
+            vector_expression_detail::EvaluateParallel(expression.Self(), items_.Get(), new_size, thread_count);
+            size_ = new_size;
+            return;
+        }
+        SimpleVector temp(::Reserve(new_size));
+        vector_expression_detail::EvaluateParallel(expression.Self(), temp.items_.Get(), new_size, thread_count);
+        temp.size_ = new_size;
+        swap(temp);
+    }
+
     // Добавляет элемент в конец вектора
     // При нехватке места увеличивает вдвое вместимость вектора
     void PushBack(const Type &item) {
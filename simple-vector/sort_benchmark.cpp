@@ -0,0 +1,139 @@
+#include "simple_vector.h"
+#include "radix_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Сравнивает Sort и ParallelSort со std::sort для разных размеров и распределений ключей.
+// Размеры растут от 2^10 до 2^max_log_size элементов.
+// Использование: sort_benchmark [max_log_size] [thread_count]
+
+namespace {
+
+    enum class Distribution {
+        UNIFORM,
+        FEW_UNIQUE,
+        SORTED,
+        REVERSED,
+    };
+
+    string GetName(Distribution distribution) {
+        switch (distribution) {
+            case Distribution::UNIFORM:
+                return "uniform"s;
+            case Distribution::FEW_UNIQUE:
+                return "few unique"s;
+            case Distribution::SORTED:
+                return "sorted"s;
+            case Distribution::REVERSED:
+                return "reversed"s;
+        }
+        return {};
+    }
+
+    uint64_t MakeKey(Distribution distribution, size_t index, size_t size, mt19937_64 &generator) {
+        switch (distribution) {
+            case Distribution::UNIFORM:
+                return generator();
+            case Distribution::FEW_UNIQUE:
+                return generator() % 16;
+            case Distribution::SORTED:
+                return index;
+            case Distribution::REVERSED:
+                return size - index;
+        }
+        return 0;
+    }
+
+    template<typename Type>
+    Type MakeItem(uint64_t key, mt19937_64 &generator) {
+        if constexpr (is_same_v<Type, pair<uint32_t, uint32_t>>) {
+            return {static_cast<uint32_t>(key), static_cast<uint32_t>(generator())};
+        } else {
+            return static_cast<Type>(key);
+        }
+    }
+
+    template<typename Function>
+    double MeasureMs(Function function) {
+        const auto start = chrono::steady_clock::now();
+        function();
+        const auto finish = chrono::steady_clock::now();
+        return chrono::duration<double, milli>(finish - start).count();
+    }
+
+    template<typename Type>
+    void RunBenchmark(const string &type_name, Distribution distribution, size_t size, size_t thread_count,
+                      SortBuffer<Type> &buffer, mt19937_64 &generator) {
+        SimpleVector<Type> source(size);
+        for (size_t i = 0; i < size; ++i) {
+            source[i] = MakeItem<Type>(MakeKey(distribution, i, size, generator), generator);
+        }
+
+        SimpleVector<Type> expected = source;
+        const double std_sort_ms = MeasureMs([&] {
+            sort(expected.begin(), expected.end());
+        });
+
+        SimpleVector<Type> radix_sorted = source;
+        const double radix_sort_ms = MeasureMs([&] {
+            Sort(radix_sorted, buffer);
+        });
+
+        SimpleVector<Type> parallel_sorted = source;
+        const double parallel_sort_ms = MeasureMs([&] {
+            ParallelSort(parallel_sorted, buffer, thread_count);
+        });
+
+        if (radix_sorted != expected || parallel_sorted != expected) {
+            cerr << "Wrong order for "s << type_name << ", "s << GetName(distribution) << ", size "s << size << endl;
+            exit(1);
+        }
+
+        cout << setw(12) << type_name
+             << setw(12) << GetName(distribution)
+             << setw(12) << size
+             << setw(14) << fixed << setprecision(2) << std_sort_ms
+             << setw(14) << radix_sort_ms
+             << setw(14) << parallel_sort_ms << endl;
+    }
+
+    template<typename Type>
+    void RunBenchmarks(const string &type_name, size_t max_log_size, size_t thread_count, mt19937_64 &generator) {
+        // Буфер один на все запуски: время выделения памяти не попадает в замеры
+        SortBuffer<Type> buffer(Reserve(size_t{1} << max_log_size));
+        for (const Distribution distribution: {Distribution::UNIFORM, Distribution::FEW_UNIQUE,
+                                               Distribution::SORTED, Distribution::REVERSED}) {
+            for (size_t log_size = 10; log_size <= max_log_size; log_size += 3) {
+                RunBenchmark(type_name, distribution, size_t{1} << log_size, thread_count, buffer, generator);
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const size_t max_log_size = argc > 1 ? stoul(argv[1]) : 25;
+    const size_t thread_count = argc > 2 ? stoul(argv[2]) : 0;
+
+    mt19937_64 generator(42);
+    cout << setw(12) << "type"s
+         << setw(12) << "keys"s
+         << setw(12) << "size"s
+         << setw(14) << "std::sort ms"s
+         << setw(14) << "Sort ms"s
+         << setw(14) << "Parallel ms"s << endl;
+    RunBenchmarks<uint64_t>("uint64"s, max_log_size, thread_count, generator);
+    RunBenchmarks<pair<uint32_t, uint32_t>>("pair"s, max_log_size, thread_count, generator);
+    return 0;
+}
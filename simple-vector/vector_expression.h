@@ -0,0 +1,283 @@
+#pragma once
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+template<typename Type>
+class SimpleVector;
+
+// Базовый класс ленивых выражений (CRTP).
+// Узел выражения ничего не вычисляет при построении: значение i-го элемента
+// считается только при обращении к operator[], поэтому выражение вида a * 2 + b - c
+// вычисляется за один проход без промежуточных векторов.
+// Листья ссылаются на исходные векторы, поэтому выражение нельзя хранить дольше них
+template<typename Derived>
+class VectorExpression {
+public:
+    const Derived &Self() const noexcept {
+        return static_cast<const Derived &>(*this);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return Self().GetSize();
+    }
+
+    decltype(auto) operator[](size_t index) const {
+        return Self()[index];
+    }
+};
+
+// Лист выражения: ссылается на элементы SimpleVector, не владея ими
+template<typename Type>
+class VectorOperand : public VectorExpression<VectorOperand<Type>> {
+public:
+    using ValueType = Type;
+
+    explicit VectorOperand(const SimpleVector<Type> &vector) noexcept: data_(vector.begin()),
+                                                                       size_(vector.GetSize()) {}
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    const Type &operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+private:
+    const Type *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Лист выражения: скаляр, одинаковый для всех позиций.
+// Собственного размера не имеет, размер берётся у второго операнда
+template<typename Type>
+class ScalarOperand : public VectorExpression<ScalarOperand<Type>> {
+public:
+    using ValueType = Type;
+
+    explicit ScalarOperand(Type value) noexcept: value_(value) {}
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return 0;
+    }
+
+    const Type &operator[](size_t) const noexcept {
+        return value_;
+    }
+
+private:
+    Type value_;
+};
+
+template<typename Expression>
+struct IsScalarOperand : std::false_type {
+};
+
+template<typename Type>
+struct IsScalarOperand<ScalarOperand<Type>> : std::true_type {
+};
+
+template<typename Operation, typename Operand>
+class UnaryExpression : public VectorExpression<UnaryExpression<Operation, Operand>> {
+public:
+    using ValueType = std::decay_t<decltype(std::declval<Operation>()(
+            std::declval<typename Operand::ValueType>()))>;
+
+    explicit UnaryExpression(Operand operand) : operand_(std::move(operand)) {}
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return operand_.GetSize();
+    }
+
+    ValueType operator[](size_t index) const {
+        return Operation{}(operand_[index]);
+    }
+
+private:
+    Operand operand_;
+};
+
+template<typename Operation, typename Lhs, typename Rhs>
+class BinaryExpression : public VectorExpression<BinaryExpression<Operation, Lhs, Rhs>> {
+public:
+    using ValueType = std::decay_t<decltype(std::declval<Operation>()(
+            std::declval<typename Lhs::ValueType>(), std::declval<typename Rhs::ValueType>()))>;
+
+    BinaryExpression(Lhs lhs, Rhs rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+        assert(IsScalarOperand<Lhs>::value || IsScalarOperand<Rhs>::value
+               || lhs_.GetSize() == rhs_.GetSize());
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        if constexpr (IsScalarOperand<Lhs>::value) {
+            return rhs_.GetSize();
+        } else {
+            return lhs_.GetSize();
+        }
+    }
+
+    ValueType operator[](size_t index) const {
+        return Operation{}(lhs_[index], rhs_[index]);
+    }
+
+private:
+    Lhs lhs_;
+    Rhs rhs_;
+};
+
+namespace vector_expression_detail {
+
+    template<typename Type>
+    struct IsSimpleVector : std::false_type {
+    };
+
+    template<typename Type>
+    struct IsSimpleVector<SimpleVector<Type>> : std::true_type {
+    };
+
+    template<typename Type>
+    struct IsExpression : std::is_base_of<VectorExpression<Type>, Type> {
+    };
+
+    // Операнд, который может стоять в выражении: узел, SimpleVector или скаляр
+    template<typename Type>
+    struct IsOperand : std::bool_constant<IsExpression<Type>::value
+                                          || IsSimpleVector<Type>::value
+                                          || std::is_arithmetic_v<Type>> {
+    };
+
+    template<typename Lhs, typename Rhs,
+            typename L = std::decay_t<Lhs>, typename R = std::decay_t<Rhs>>
+    using EnableArithmetic = std::enable_if_t<
+            IsOperand<L>::value && IsOperand<R>::value
+            && !(std::is_arithmetic_v<L> && std::is_arithmetic_v<R>)>;
+
+    // Сравнение двух SimpleVector остаётся лексикографическим,
+    // поэлементное сравнение строится, только если хотя бы один операнд — выражение или скаляр
+    template<typename Lhs, typename Rhs,
+            typename L = std::decay_t<Lhs>, typename R = std::decay_t<Rhs>>
+    using EnableComparison = std::enable_if_t<
+            IsOperand<L>::value && IsOperand<R>::value
+            && !(std::is_arithmetic_v<L> && std::is_arithmetic_v<R>)
+            && !(IsSimpleVector<L>::value && IsSimpleVector<R>::value)>;
+
+    template<typename Type>
+    VectorOperand<Type> MakeOperand(const SimpleVector<Type> &vector) {
+        return VectorOperand<Type>(vector);
+    }
+
+    template<typename Type>
+    auto MakeOperand(const Type &value) {
+        if constexpr (std::is_arithmetic_v<Type>) {
+            return ScalarOperand<Type>(value);
+        } else {
+            return value;
+        }
+    }
+
+    template<typename Operation, typename Lhs, typename Rhs>
+    auto MakeBinary(const Lhs &lhs, const Rhs &rhs) {
+        auto left = MakeOperand(lhs);
+        auto right = MakeOperand(rhs);
+        return BinaryExpression<Operation, decltype(left), decltype(right)>(std::move(left), std::move(right));
+    }
+
+    // Вычисляет элементы [first, last) выражения в out одним проходом
+    template<typename Expression, typename Type>
+    void Evaluate(const Expression &expression, Type *out, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            out[i] = expression[i];
+        }
+    }
+
+    // Делит диапазон на равные части и вычисляет их в thread_count потоках.
+    // Короткие выражения считаются в текущем потоке: запуск потоков дороже самого вычисления
+    template<typename Expression, typename Type>
+    void EvaluateParallel(const Expression &expression, Type *out, size_t size, size_t thread_count) {
+        const size_t min_chunk_size = 1 << 14;
+        thread_count = parallel_detail::GetThreadCount(thread_count, size, min_chunk_size);
+        if (thread_count == 1) {
+            Evaluate(expression, out, 0, size);
+            return;
+        }
+        const size_t chunk_size = (size + thread_count - 1) / thread_count;
+        parallel_detail::RunInThreads(thread_count, [&expression, out, size, chunk_size](size_t t) {
+            const size_t first = std::min(size, t * chunk_size);
+            Evaluate(expression, out, first, std::min(size, first + chunk_size));
+        });
+    }
+
+} // namespace vector_expression_detail
+
+// Позволяет явно построить поэлементное выражение из SimpleVector,
+// например, чтобы сравнить два вектора поэлементно: AsExpression(a) < b
+template<typename Type>
+VectorOperand<Type> AsExpression(const SimpleVector<Type> &vector) {
+    return VectorOperand<Type>(vector);
+}
+
+template<typename Operand, typename = std::enable_if_t<
+        vector_expression_detail::IsExpression<Operand>::value
+        || vector_expression_detail::IsSimpleVector<Operand>::value>>
+auto operator-(const Operand &operand) {
+    auto inner = vector_expression_detail::MakeOperand(operand);
+    return UnaryExpression<std::negate<>, decltype(inner)>(std::move(inner));
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableArithmetic<Lhs, Rhs>>
+auto operator+(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::plus<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableArithmetic<Lhs, Rhs>>
+auto operator-(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::minus<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableArithmetic<Lhs, Rhs>>
+auto operator*(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::multiplies<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableArithmetic<Lhs, Rhs>>
+auto operator/(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::divides<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableComparison<Lhs, Rhs>>
+auto operator==(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::equal_to<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableComparison<Lhs, Rhs>>
+auto operator!=(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::not_equal_to<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableComparison<Lhs, Rhs>>
+auto operator<(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::less<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableComparison<Lhs, Rhs>>
+auto operator<=(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::less_equal<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableComparison<Lhs, Rhs>>
+auto operator>(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::greater<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, typename = vector_expression_detail::EnableComparison<Lhs, Rhs>>
+auto operator>=(const Lhs &lhs, const Rhs &rhs) {
+    return vector_expression_detail::MakeBinary<std::greater_equal<>>(lhs, rhs);
+}